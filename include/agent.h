@@ -0,0 +1,30 @@
+#ifndef AGENT_H
+#define AGENT_H
+
+#include "endpoint.h"
+#include "snapshot_codec.h"
+#include <string>
+
+// --agent mode: samples this host and streams snapshots to a collector.
+// Frames that don't fit in the bounded send buffer are dropped and the
+// next sample is sent as a FULL snapshot, so a slow collector only costs
+// resolution. Reconnects with backoff when the collector goes away.
+class MonitorAgent {
+public:
+    static const size_t kMaxPendingBytes = 4 * 1024 * 1024;
+
+    MonitorAgent(const Endpoint& collector, const std::string& host_name, int interval_ms = 1000);
+
+    void run();
+
+private:
+    Endpoint collector;
+    std::string host_name;
+    int interval_ms;
+    SnapshotEncoder encoder;
+
+    // Returns when the connection fails
+    void streamTo(int fd);
+};
+
+#endif
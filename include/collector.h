@@ -0,0 +1,84 @@
+#ifndef COLLECTOR_H
+#define COLLECTOR_H
+
+#include "endpoint.h"
+#include "snapshot_codec.h"
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+
+struct HostSummary {
+    std::string name;
+    bool connected;
+    double seconds_since_update;
+    SystemInfo system;
+};
+
+// --collector mode: accepts any number of agents on one poll() loop
+// running in a background thread. Each connection reads into a bounded
+// buffer and gets at most one chunk per loop iteration, so a chatty agent
+// can't starve the others and a slow collector pushes back through TCP
+// flow control. The UI thread reads copies through hostSummaries() and
+// hostSnapshot().
+class MonitorCollector {
+public:
+    static const size_t kReadChunk = 64 * 1024;
+
+    explicit MonitorCollector(const Endpoint& listen_on);
+    ~MonitorCollector();
+
+    void start();
+    void stop();
+
+    std::vector<HostSummary> hostSummaries() const;
+    bool hostSnapshot(const std::string& name, SystemInfo& sys_info,
+                      std::vector<ProcessInfo>& processes) const;
+
+private:
+    struct Connection {
+        int fd;
+        unsigned long id;
+        std::string host;   // Empty until HELLO
+        std::vector<char> buffer;
+        size_t buffered;
+    };
+
+    struct HostState {
+        HostSnapshot snapshot;
+        int connections;
+        unsigned long active_connection;  // Agent whose frames apply; 0 if none
+        std::chrono::steady_clock::time_point last_update;
+
+        HostState() : connections(0), active_connection(0) {}
+    };
+
+    Endpoint endpoint;
+    int listen_fd;
+    bool owns_socket_path;  // Unix endpoint: the socket file we bound
+    dev_t socket_dev;
+    ino_t socket_ino;
+    int wake_pipe[2];
+    std::thread event_thread;
+    bool running;
+
+    std::vector<Connection> connections;
+    unsigned long next_connection_id;
+    // Out of fds: stop polling the listen socket for a while instead of
+    // spinning on it while it stays readable
+    std::chrono::steady_clock::time_point accept_paused_until;
+    mutable std::mutex hosts_mutex;
+    std::map<std::string, HostState> hosts;
+
+    void eventLoop();
+    bool pollOnce();  // False once stop() was requested
+    void acceptConnections();
+    bool readConnection(Connection& conn);
+    bool handleFrame(Connection& conn, const char* frame, size_t len);
+    void closeConnection(Connection& conn);
+};
+
+#endif
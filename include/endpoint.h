@@ -0,0 +1,21 @@
+#ifndef ENDPOINT_H
+#define ENDPOINT_H
+
+#include <string>
+
+// "unix:/path/to.sock" or "host:port" (host may be empty when listening)
+struct Endpoint {
+    bool is_unix;
+    std::string path;
+    std::string host;
+    std::string port;
+
+    static Endpoint parse(const std::string& spec);
+    std::string toString() const;
+
+    // Both return a non-blocking socket, or throw std::runtime_error
+    int listenSocket() const;
+    int connectSocket() const;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef MEMORY_DETAIL_H
+#define MEMORY_DETAIL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Breakdown from /proc/<pid>/smaps_rollup, all in kB
+struct MemoryDetail {
+    bool valid;   // False if the file was unreadable (permissions, exited)
+    long pss_kb;
+    long uss_kb;  // private_clean + private_dirty
+    long swap_kb;
+    long shared_clean_kb;
+    long shared_dirty_kb;
+    long private_clean_kb;
+    long private_dirty_kb;
+    std::chrono::steady_clock::time_point fetched_at;
+};
+
+// smaps_rollup walks every VMA of a process, which is far too slow to do
+// for the whole process list every second. The UI tells this cache which
+// PIDs are on screen; a background thread reads only those, refreshes
+// them every refresh_ms, and the UI only ever reads the cached copies.
+class MemoryDetailCache {
+public:
+    explicit MemoryDetailCache(int refresh_ms = 5000);
+    ~MemoryDetailCache();
+
+    void start();
+    void stop();
+
+    // Replaces the set of PIDs worth keeping fresh
+    void request(const std::vector<int>& pids);
+    bool lookup(int pid, MemoryDetail& detail) const;
+
+    static MemoryDetail readSmapsRollup(int pid);
+
+private:
+    int refresh_ms;
+    bool running;
+    bool has_new;  // request() added PIDs the worker hasn't seen
+    std::thread worker_thread;
+
+    mutable std::mutex cache_mutex;
+    std::condition_variable wake;
+    std::unordered_set<int> wanted;
+    std::unordered_map<int, MemoryDetail> cache;
+
+    void workerLoop();
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef SNAPSHOT_CODEC_H
+#define SNAPSHOT_CODEC_H
+
+#include "system_info.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Wire format shared by the agent and the collector.
+//
+// Every frame is a 4-byte big-endian length followed by that many bytes:
+// a one-byte FrameType and the body. Integers in the body are LEB128
+// varints, strings are a varint length plus bytes, and percentages are
+// sent as hundredths. After HELLO the agent sends one FULL snapshot and
+// then DELTA frames holding only changed and removed processes.
+enum FrameType {
+    FRAME_HELLO = 1,
+    FRAME_FULL = 2,
+    FRAME_DELTA = 3
+};
+
+struct HostSnapshot {
+    bool has_full;
+    SystemInfo system;
+    std::unordered_map<int, ProcessInfo> processes;
+
+    HostSnapshot();
+};
+
+class SnapshotEncoder {
+public:
+    SnapshotEncoder();
+
+    static std::string encodeHello(const std::string& host_name);
+
+    // FULL on the first call or after reset(), DELTA otherwise
+    std::string encode(const SystemInfo& sys_info, const std::vector<ProcessInfo>& processes);
+
+    // Call whenever an encoded frame is not delivered
+    void reset();
+
+private:
+    bool have_previous;
+    std::unordered_map<int, ProcessInfo> previous;
+};
+
+class SnapshotDecoder {
+public:
+    static const size_t kHeaderSize = 4;
+    static const size_t kMaxFrameSize = 16 * 1024 * 1024;
+
+    // Length of the frame (type byte + body) announced by a header
+    static uint32_t frameLength(const char* header);
+
+    static bool decodeHello(const char* body, size_t len, std::string& host_name);
+    static bool apply(int type, const char* body, size_t len, HostSnapshot& snapshot);
+};
+
+#endif
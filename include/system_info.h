@@ -12,6 +12,20 @@ struct ProcessInfo {
     double memory_usage;
     long memory_kb;
     std::string state;
+    unsigned long long cpu_jiffies;  // utime + stime
+    
+    // Sliding-window CPU percentiles, filled in by UsageStatsTracker
+    double cpu_p50;
+    double cpu_p95;
+    double cpu_p99;
+    double cpu_max;
+};
+
+// One line of /proc/pressure/<resource>: share of time stalled, last 10s
+struct PressureInfo {
+    bool available;
+    double some_avg10;
+    double full_avg10;
 };
 
 struct SystemInfo {
@@ -21,6 +35,9 @@ struct SystemInfo {
     long free_memory;
     int running_processes;
     int total_processes;
+    PressureInfo cpu_pressure;
+    PressureInfo memory_pressure;
+    PressureInfo io_pressure;
 };
 
 class SystemInfoReader {
@@ -32,6 +49,9 @@ public:
 private:
     static double calculateCPUUsage();
     static long getTotalMemory();
+    static PressureInfo getPressure(const std::string& resource);
+    static unsigned long long readTotalJiffies(unsigned long long* idle_jiffies);
+    static void updateProcessCPUUsage(std::vector<ProcessInfo>& processes);
     static ProcessInfo getProcessInfo(int pid);
     static std::string getProcessUser(int pid);
 };
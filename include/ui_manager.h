@@ -2,18 +2,27 @@
 #define UI_MANAGER_H
 
 #include "system_info.h"
+#include "usage_stats.h"
+#include "collector.h"
+#include "memory_detail.h"
 #include <ncurses.h>
 
 enum SortType {
     SORT_CPU,
     SORT_MEMORY,
     SORT_PID,
-    SORT_NAME
+    SORT_NAME,
+    SORT_CPU_P50,
+    SORT_CPU_P95,
+    SORT_CPU_P99,
+    SORT_CPU_MAX
 };
 
 class UIManager {
 public:
-    UIManager();
+    // With a collector the UI starts on the per-host summary list
+    explicit UIManager(MonitorCollector* collector = nullptr,
+                       const UsageStatsTracker& usage_stats = UsageStatsTracker());
     ~UIManager();
     
     void initializeUI();
@@ -25,9 +34,18 @@ private:
     bool sort_descending;
     int selected_process;
     bool should_exit;
+    UsageStatsTracker usage_stats;
+    int stats_window;
+    MonitorCollector* collector;
+    std::string current_host;
+    MemoryDetailCache memory_details;
+    int selected_pid;
     
     void drawHeader(const SystemInfo& sys_info);
     void drawProcessList(const vector<ProcessInfo>& processes);
+    void requestMemoryDetails(const vector<ProcessInfo>& processes);
+    void drawHostSummary(const vector<HostSummary>& hosts);
+    void drawHostList(const vector<HostSummary>& hosts);
     void drawFooter();
     void handleInput();
     vector<ProcessInfo> sortProcesses(vector<ProcessInfo> processes);
@@ -0,0 +1,77 @@
+#ifndef USAGE_STATS_H
+#define USAGE_STATS_H
+
+#include "system_info.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct PercentileSummary {
+    double p50;
+    double p95;
+    double p99;
+    double max;
+};
+
+// Fixed-size CPU% histogram over several nested sliding windows.
+// Buckets are 0.1% wide up to 1%, 0.5% up to 10% and 2.5% up to 100%.
+// Memory is one byte per sample of the longest window plus one small
+// count array per window; add() is O(1), queries are O(buckets).
+class SlidingPercentiles {
+public:
+    static const int kNumBuckets = 65;
+    static const int kNumWindows = 3;
+
+    // Each window is a sample count in [1, 65535]
+    explicit SlidingPercentiles(const int (&window_samples)[kNumWindows]);
+
+    void add(double value);
+    PercentileSummary summary(int window) const;
+
+    static int bucketFor(double value);
+    static double bucketValue(int bucket);
+
+private:
+    int windows[kNumWindows];
+    std::vector<uint8_t> ring;
+    int head;
+    int filled;
+    uint16_t counts[kNumWindows][kNumBuckets];
+
+    double percentile(int window, double q) const;
+};
+
+// Keeps one SlidingPercentiles per live process plus one for system CPU.
+// Samples are recorded at most once per sample interval regardless of how
+// often the UI loop runs.
+class UsageStatsTracker {
+public:
+    UsageStatsTracker(int sample_interval_ms = 1000,
+                      int window_1_sec = 60,
+                      int window_2_sec = 300,
+                      int window_3_sec = 900);
+
+    // Returns true if a new sample was taken
+    bool record(const SystemInfo& sys_info, const std::vector<ProcessInfo>& processes);
+    void annotate(std::vector<ProcessInfo>& processes, int window) const;
+    PercentileSummary systemSummary(int window) const;
+    std::string windowLabel(int window) const;
+
+private:
+    struct ProcessEntry {
+        SlidingPercentiles cpu;
+        unsigned long last_seen;
+    };
+
+    int sample_interval_ms;
+    int window_seconds[SlidingPercentiles::kNumWindows];
+    int window_samples[SlidingPercentiles::kNumWindows];
+    unsigned long sample_count;
+    std::chrono::steady_clock::time_point last_sample;
+    SlidingPercentiles system_cpu;
+    std::unordered_map<int, ProcessEntry> process_cpu;
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "agent.h"
+#include "system_info.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace std;
+
+MonitorAgent::MonitorAgent(const Endpoint& collector, const string& host_name, int interval_ms)
+    : collector(collector), host_name(host_name),
+      interval_ms(interval_ms > 0 ? interval_ms : 1000) {
+}
+
+void MonitorAgent::run() {
+    int backoff_ms = 1000;
+
+    while (true) {
+        int fd = -1;
+        try {
+            fd = collector.connectSocket();
+        } catch (const exception& e) {
+            cerr << "agent: " << e.what() << ", retrying in " << backoff_ms / 1000 << "s" << endl;
+            this_thread::sleep_for(chrono::milliseconds(backoff_ms));
+            backoff_ms = min(backoff_ms * 2, 30000);
+            continue;
+        }
+
+        cerr << "agent: streaming to " << collector.toString() << " as " << host_name << endl;
+        backoff_ms = 1000;
+        streamTo(fd);
+        close(fd);
+        cerr << "agent: lost connection to " << collector.toString() << endl;
+    }
+}
+
+void MonitorAgent::streamTo(int fd) {
+    // A fresh connection always starts from a full snapshot
+    encoder.reset();
+    string pending = SnapshotEncoder::encodeHello(host_name);
+    size_t sent = 0;
+
+    auto next_sample = chrono::steady_clock::now();
+
+    while (true) {
+        auto now = chrono::steady_clock::now();
+        if (now >= next_sample) {
+            SystemInfo sys_info = SystemInfoReader::getSystemInfo();
+            vector<ProcessInfo> processes = SystemInfoReader::getProcessList();
+            string frame = encoder.encode(sys_info, processes);
+
+            size_t backlog = pending.size() - sent;
+            if (backlog == 0 || backlog + frame.size() <= kMaxPendingBytes) {
+                pending.erase(0, sent);
+                sent = 0;
+                pending.append(frame);
+            } else {
+                // Collector is behind: drop this frame and resync with a FULL one
+                encoder.reset();
+            }
+
+            next_sample += chrono::milliseconds(interval_ms);
+            if (next_sample < now) next_sample = now + chrono::milliseconds(interval_ms);
+        }
+
+        int wait_ms = (int)chrono::duration_cast<chrono::milliseconds>(
+            next_sample - chrono::steady_clock::now()).count();
+        pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN | (sent < pending.size() ? POLLOUT : 0);
+        pfd.revents = 0;
+
+        int rc = poll(&pfd, 1, max(0, wait_ms));
+        if (rc < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (rc == 0) continue;
+
+        if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) return;
+
+        if (pfd.revents & POLLIN) {
+            // The collector never sends data; readable means EOF
+            char buf[256];
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) return;
+        }
+
+        if (pfd.revents & POLLOUT) {
+            ssize_t n = send(fd, pending.data() + sent, pending.size() - sent, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) return;
+            } else {
+                sent += n;
+                if (sent == pending.size()) {
+                    pending.clear();
+                    sent = 0;
+                }
+            }
+        }
+    }
+}
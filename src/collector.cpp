@@ -0,0 +1,271 @@
+#include "collector.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Largest a connection buffer can grow: one maximal frame plus a read chunk
+static const size_t kMaxBufferBytes =
+    SnapshotDecoder::kHeaderSize + SnapshotDecoder::kMaxFrameSize + MonitorCollector::kReadChunk;
+
+MonitorCollector::MonitorCollector(const Endpoint& listen_on)
+    : endpoint(listen_on), listen_fd(-1), owns_socket_path(false),
+      socket_dev(0), socket_ino(0), running(false), next_connection_id(1) {
+    wake_pipe[0] = wake_pipe[1] = -1;
+}
+
+MonitorCollector::~MonitorCollector() {
+    stop();
+}
+
+void MonitorCollector::start() {
+    if (running) return;
+
+    listen_fd = endpoint.listenSocket();
+    struct stat st;
+    if (endpoint.is_unix && lstat(endpoint.path.c_str(), &st) == 0) {
+        owns_socket_path = true;
+        socket_dev = st.st_dev;
+        socket_ino = st.st_ino;
+    }
+    if (pipe(wake_pipe) < 0) {
+        close(listen_fd);
+        listen_fd = -1;
+        throw runtime_error(string("pipe: ") + strerror(errno));
+    }
+
+    running = true;
+    event_thread = thread(&MonitorCollector::eventLoop, this);
+}
+
+void MonitorCollector::stop() {
+    if (!running) return;
+
+    char byte = 0;
+    if (write(wake_pipe[1], &byte, 1) < 0) {
+        // Nothing else to try; join() below still waits for the loop
+    }
+    event_thread.join();
+    running = false;
+
+    for (auto& conn : connections) {
+        closeConnection(conn);
+    }
+    connections.clear();
+
+    close(listen_fd);
+    close(wake_pipe[0]);
+    close(wake_pipe[1]);
+    listen_fd = wake_pipe[0] = wake_pipe[1] = -1;
+    // Only remove the socket file if it is still the one we bound
+    struct stat st;
+    if (owns_socket_path && lstat(endpoint.path.c_str(), &st) == 0 &&
+        S_ISSOCK(st.st_mode) && st.st_dev == socket_dev && st.st_ino == socket_ino) {
+        unlink(endpoint.path.c_str());
+    }
+    owns_socket_path = false;
+}
+
+vector<HostSummary> MonitorCollector::hostSummaries() const {
+    lock_guard<mutex> lock(hosts_mutex);
+    auto now = chrono::steady_clock::now();
+
+    vector<HostSummary> summaries;
+    summaries.reserve(hosts.size());
+    for (const auto& entry : hosts) {
+        HostSummary summary;
+        summary.name = entry.first;
+        summary.connected = entry.second.connections > 0;
+        summary.system = entry.second.snapshot.system;
+        summary.seconds_since_update = entry.second.snapshot.has_full
+            ? chrono::duration<double>(now - entry.second.last_update).count()
+            : -1.0;
+        summaries.push_back(summary);
+    }
+    return summaries;
+}
+
+bool MonitorCollector::hostSnapshot(const string& name, SystemInfo& sys_info,
+                                    vector<ProcessInfo>& processes) const {
+    lock_guard<mutex> lock(hosts_mutex);
+    auto it = hosts.find(name);
+    if (it == hosts.end() || !it->second.snapshot.has_full) return false;
+
+    sys_info = it->second.snapshot.system;
+    processes.clear();
+    processes.reserve(it->second.snapshot.processes.size());
+    for (const auto& entry : it->second.snapshot.processes) {
+        processes.push_back(entry.second);
+    }
+    return true;
+}
+
+void MonitorCollector::eventLoop() {
+    while (true) {
+        try {
+            if (!pollOnce()) return;
+        } catch (const exception&) {
+            // Out of memory outside any one connection; an exception escaping
+            // the thread would terminate the whole collector, so back off
+            this_thread::sleep_for(chrono::milliseconds(100));
+        }
+    }
+}
+
+bool MonitorCollector::pollOnce() {
+    vector<pollfd> fds;
+    fds.reserve(connections.size() + 2);
+    fds.push_back(pollfd{wake_pipe[0], POLLIN, 0});
+    // poll() ignores negative fds, which keeps the indices below stable
+    auto now = chrono::steady_clock::now();
+    bool accept_paused = now < accept_paused_until;
+    fds.push_back(pollfd{accept_paused ? -1 : listen_fd, POLLIN, 0});
+    for (const auto& conn : connections) {
+        fds.push_back(pollfd{conn.fd, POLLIN, 0});
+    }
+
+    int timeout_ms = -1;
+    if (accept_paused) {
+        timeout_ms = (int)chrono::duration_cast<chrono::milliseconds>(
+            accept_paused_until - now).count() + 1;
+    }
+    if (poll(fds.data(), fds.size(), timeout_ms) < 0) {
+        // Only the wake pipe ends the loop; ENOMEM and the like pass
+        if (errno != EINTR) this_thread::sleep_for(chrono::milliseconds(100));
+        return true;
+    }
+    if (fds[0].revents) return false;
+
+    // One read per ready connection per iteration keeps agents fair
+    size_t polled = fds.size() - 2;
+    for (size_t i = 0; i < polled; i++) {
+        if (!fds[i + 2].revents) continue;
+
+        bool keep = false;
+        try {
+            keep = readConnection(connections[i]);
+        } catch (const exception&) {
+            // e.g. bad_alloc on a hostile frame: drop the agent, not the collector
+        }
+        if (!keep) closeConnection(connections[i]);
+    }
+    connections.erase(remove_if(connections.begin(), connections.end(),
+                                [](const Connection& c) { return c.fd < 0; }),
+                      connections.end());
+
+    if (fds[1].revents & POLLIN) acceptConnections();
+    return true;
+}
+
+void MonitorCollector::acceptConnections() {
+    while (true) {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+
+            // EMFILE, ENFILE, ENOBUFS...: the pending agent stays in the
+            // backlog; retry once some connections have had a chance to close
+            accept_paused_until = chrono::steady_clock::now() + chrono::milliseconds(250);
+            return;
+        }
+
+        Connection conn;
+        conn.fd = fd;
+        conn.id = next_connection_id++;
+        conn.buffered = 0;
+        connections.push_back(conn);
+    }
+}
+
+bool MonitorCollector::readConnection(Connection& conn) {
+    const size_t header = SnapshotDecoder::kHeaderSize;
+
+    if (conn.buffer.size() < conn.buffered + kReadChunk) {
+        conn.buffer.resize(min(conn.buffered + kReadChunk, kMaxBufferBytes));
+    }
+
+    ssize_t n = recv(conn.fd, conn.buffer.data() + conn.buffered,
+                     conn.buffer.size() - conn.buffered, 0);
+    if (n == 0) return false;
+    if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    conn.buffered += n;
+
+    size_t offset = 0;
+    while (conn.buffered - offset >= header) {
+        uint32_t len = SnapshotDecoder::frameLength(conn.buffer.data() + offset);
+        if (len == 0 || len > SnapshotDecoder::kMaxFrameSize) return false;
+        // Don't buffer megabytes for a peer that hasn't said HELLO yet
+        if (conn.host.empty() && len > kReadChunk) return false;
+        if (conn.buffered - offset < header + len) break;
+
+        if (!handleFrame(conn, conn.buffer.data() + offset + header, len)) return false;
+        offset += header + len;
+    }
+
+    if (offset > 0) {
+        memmove(conn.buffer.data(), conn.buffer.data() + offset, conn.buffered - offset);
+        conn.buffered -= offset;
+    }
+
+    // Give back the space a large FULL frame needed
+    if (conn.buffered == 0 && conn.buffer.size() > 4 * kReadChunk) {
+        vector<char>().swap(conn.buffer);
+    }
+    return true;
+}
+
+bool MonitorCollector::handleFrame(Connection& conn, const char* frame, size_t len) {
+    int type = (uint8_t)frame[0];
+
+    if (conn.host.empty()) {
+        string name;
+        if (type != FRAME_HELLO || !SnapshotDecoder::decodeHello(frame + 1, len - 1, name)) {
+            return false;
+        }
+
+        lock_guard<mutex> lock(hosts_mutex);
+        HostState& host = hosts[name];
+        host.connections++;
+        // The newest stream wins and starts from its own FULL frame
+        host.active_connection = conn.id;
+        host.snapshot.has_full = false;
+        conn.host = name;
+        return true;
+    }
+
+    lock_guard<mutex> lock(hosts_mutex);
+    HostState& host = hosts[conn.host];
+    // The active agent went away: the first remaining one to speak takes
+    // over. Its DELTAs can't apply without a FULL, so apply() fails and the
+    // agent reconnects and starts over with HELLO and a FULL snapshot.
+    if (host.active_connection == 0) host.active_connection = conn.id;
+    if (host.active_connection != conn.id) return true;
+    if (!SnapshotDecoder::apply(type, frame + 1, len - 1, host.snapshot)) return false;
+    host.last_update = chrono::steady_clock::now();
+    return true;
+}
+
+void MonitorCollector::closeConnection(Connection& conn) {
+    if (conn.fd < 0) return;
+    close(conn.fd);
+    conn.fd = -1;
+
+    if (!conn.host.empty()) {
+        lock_guard<mutex> lock(hosts_mutex);
+        HostState& host = hosts[conn.host];
+        host.connections--;
+        if (host.active_connection == conn.id) {
+            host.active_connection = 0;
+            // Keep the last snapshot of a host that went down, but not one
+            // another agent is about to replace
+            if (host.connections > 0) host.snapshot.has_full = false;
+        }
+    }
+}
@@ -0,0 +1,174 @@
+#include "endpoint.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+static void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        close(fd);
+        throw runtime_error(string("fcntl: ") + strerror(errno));
+    }
+}
+
+static sockaddr_un unixAddress(const string& path) {
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        throw runtime_error("invalid unix socket path: " + path);
+    }
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return addr;
+}
+
+// Removes a leftover socket from a collector that died, but never a regular
+// file (typo in the path) or a socket someone is still listening on
+static void removeStaleSocket(const string& path) {
+    struct stat st;
+    if (lstat(path.c_str(), &st) < 0) {
+        if (errno == ENOENT) return;
+        throw runtime_error("cannot stat " + path + ": " + strerror(errno));
+    }
+    if (!S_ISSOCK(st.st_mode)) {
+        throw runtime_error(path + " exists and is not a socket");
+    }
+
+    sockaddr_un addr = unixAddress(path);
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) throw runtime_error(string("socket: ") + strerror(errno));
+    int rc = connect(probe, (sockaddr*)&addr, sizeof(addr));
+    int err = errno;
+    close(probe);
+
+    if (rc == 0) throw runtime_error(path + " is already in use by another collector");
+    if (err != ECONNREFUSED) {
+        throw runtime_error("cannot probe " + path + ": " + strerror(err));
+    }
+    unlink(path.c_str());
+}
+
+Endpoint Endpoint::parse(const string& spec) {
+    Endpoint ep;
+    ep.is_unix = false;
+
+    if (spec.compare(0, 5, "unix:") == 0) {
+        ep.is_unix = true;
+        ep.path = spec.substr(5);
+        if (ep.path.empty()) throw runtime_error("missing unix socket path in '" + spec + "'");
+        return ep;
+    }
+
+    size_t colon = spec.rfind(':');
+    if (colon == string::npos) {
+        ep.port = spec;
+    } else {
+        ep.host = spec.substr(0, colon);
+        ep.port = spec.substr(colon + 1);
+    }
+    // Allow "[::1]:9000"
+    if (ep.host.size() >= 2 && ep.host[0] == '[' && ep.host.back() == ']') {
+        ep.host = ep.host.substr(1, ep.host.size() - 2);
+    }
+    if (ep.port.empty()) throw runtime_error("missing port in '" + spec + "'");
+    return ep;
+}
+
+string Endpoint::toString() const {
+    if (is_unix) return "unix:" + path;
+    return host + ":" + port;
+}
+
+int Endpoint::listenSocket() const {
+    if (is_unix) {
+        sockaddr_un addr = unixAddress(path);
+        removeStaleSocket(path);
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) throw runtime_error(string("socket: ") + strerror(errno));
+
+        if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+            int err = errno;
+            close(fd);
+            throw runtime_error("cannot listen on " + toString() + ": " + strerror(err));
+        }
+        setNonBlocking(fd);
+        return fd;
+    }
+
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+
+    addrinfo* result = nullptr;
+    int rc = getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result);
+    if (rc != 0) throw runtime_error("cannot resolve " + toString() + ": " + gai_strerror(rc));
+
+    int fd = -1;
+    for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && listen(fd, SOMAXCONN) == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(result);
+
+    if (fd < 0) throw runtime_error("cannot listen on " + toString() + ": " + strerror(errno));
+    setNonBlocking(fd);
+    return fd;
+}
+
+int Endpoint::connectSocket() const {
+    if (is_unix) {
+        sockaddr_un addr = unixAddress(path);
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) throw runtime_error(string("socket: ") + strerror(errno));
+
+        if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+            int err = errno;
+            close(fd);
+            throw runtime_error("cannot connect to " + toString() + ": " + strerror(err));
+        }
+        setNonBlocking(fd);
+        return fd;
+    }
+
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* result = nullptr;
+    int rc = getaddrinfo(host.empty() ? "localhost" : host.c_str(), port.c_str(), &hints, &result);
+    if (rc != 0) throw runtime_error("cannot resolve " + toString() + ": " + gai_strerror(rc));
+
+    int fd = -1;
+    int err = 0;
+    for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        err = errno;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(result);
+
+    if (fd < 0) throw runtime_error("cannot connect to " + toString() + ": " + strerror(err));
+    setNonBlocking(fd);
+    return fd;
+}
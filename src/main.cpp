@@ -1,15 +1,101 @@
 #include "ui_manager.h"
+#include "agent.h"
+#include "collector.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <unistd.h>
+
+static void printUsage(const char* prog) {
+    std::cerr << "Usage:\n"
+              << "  " << prog << " [--windows <sec,sec,sec>]        local dashboard\n"
+              << "  " << prog << " --agent <endpoint> [--name <host>] [--interval <ms>]\n"
+              << "  " << prog << " --collector <endpoint>\n"
+              << "\n"
+              << "<endpoint> is host:port or unix:/path/to.sock\n"
+              << "--windows sets the three CPU percentile windows (default 60,300,900)\n";
+}
+
+// "60,300,900" -> {60, 300, 900}; one sample per second, so at most 65535 each
+static bool parseWindows(const char* spec, int (&windows)[SlidingPercentiles::kNumWindows]) {
+    const char* p = spec;
+    for (int i = 0; i < SlidingPercentiles::kNumWindows; i++) {
+        char* end = nullptr;
+        long value = strtol(p, &end, 10);
+        if (end == p || value < 1 || value > 65535) return false;
+        windows[i] = (int)value;
+
+        bool last = i == SlidingPercentiles::kNumWindows - 1;
+        if (*end != (last ? '\0' : ',')) return false;
+        p = end + 1;
+    }
+    return true;
+}
+
+static std::string defaultHostName() {
+    char name[256];
+    if (gethostname(name, sizeof(name)) != 0) return "localhost";
+    name[sizeof(name) - 1] = '\0';
+    return name;
+}
+
+int main(int argc, char* argv[]) {
+    std::string agent_endpoint;
+    std::string collector_endpoint;
+    std::string host_name = defaultHostName();
+    int interval_ms = 1000;
+    int windows[SlidingPercentiles::kNumWindows] = {60, 300, 900};
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--agent") == 0 && has_value) {
+            agent_endpoint = argv[++i];
+        } else if (strcmp(argv[i], "--collector") == 0 && has_value) {
+            collector_endpoint = argv[++i];
+        } else if (strcmp(argv[i], "--name") == 0 && has_value) {
+            host_name = argv[++i];
+        } else if (strcmp(argv[i], "--interval") == 0 && has_value) {
+            interval_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--windows") == 0 && has_value) {
+            if (!parseWindows(argv[++i], windows)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!agent_endpoint.empty() && !collector_endpoint.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
 
-int main() {
     try {
-        UIManager ui_manager;
+        if (!agent_endpoint.empty()) {
+            MonitorAgent agent(Endpoint::parse(agent_endpoint), host_name, interval_ms);
+            agent.run();
+            return 0;
+        }
+
+        if (!collector_endpoint.empty()) {
+            MonitorCollector collector(Endpoint::parse(collector_endpoint));
+            collector.start();
+
+            UIManager ui_manager(&collector);
+            ui_manager.initializeUI();
+            ui_manager.mainLoop();
+            return 0;
+        }
+
+        UIManager ui_manager(nullptr, UsageStatsTracker(1000, windows[0], windows[1], windows[2]));
         ui_manager.initializeUI();
         ui_manager.mainLoop();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
     }
-    
+
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,127 @@
+#include "memory_detail.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace std;
+
+MemoryDetailCache::MemoryDetailCache(int refresh_ms)
+    : refresh_ms(refresh_ms > 0 ? refresh_ms : 5000), running(false), has_new(false) {
+}
+
+MemoryDetailCache::~MemoryDetailCache() {
+    stop();
+}
+
+void MemoryDetailCache::start() {
+    lock_guard<mutex> lock(cache_mutex);
+    if (running) return;
+    running = true;
+    worker_thread = thread(&MemoryDetailCache::workerLoop, this);
+}
+
+void MemoryDetailCache::stop() {
+    {
+        lock_guard<mutex> lock(cache_mutex);
+        if (!running) return;
+        running = false;
+    }
+    wake.notify_all();
+    worker_thread.join();
+}
+
+void MemoryDetailCache::request(const vector<int>& pids) {
+    bool added = false;
+    {
+        lock_guard<mutex> lock(cache_mutex);
+        wanted.clear();
+        for (int pid : pids) {
+            wanted.insert(pid);
+            if (cache.find(pid) == cache.end()) added = true;
+        }
+        has_new = has_new || added;
+    }
+    // Rows that just scrolled into view shouldn't wait for the next round
+    if (added) wake.notify_all();
+}
+
+bool MemoryDetailCache::lookup(int pid, MemoryDetail& detail) const {
+    lock_guard<mutex> lock(cache_mutex);
+    auto it = cache.find(pid);
+    if (it == cache.end()) return false;
+    detail = it->second;
+    return true;
+}
+
+MemoryDetail MemoryDetailCache::readSmapsRollup(int pid) {
+    MemoryDetail detail = MemoryDetail();
+    detail.fetched_at = chrono::steady_clock::now();
+
+    ifstream rollup("/proc/" + to_string(pid) + "/smaps_rollup");
+    if (!rollup) return detail;
+
+    string line;
+    bool saw_pss = false;
+    while (getline(rollup, line)) {
+        long value = 0;
+        if (sscanf(line.c_str(), "Pss: %ld kB", &value) == 1) {
+            detail.pss_kb = value;
+            saw_pss = true;
+        } else if (sscanf(line.c_str(), "Shared_Clean: %ld kB", &value) == 1) {
+            detail.shared_clean_kb = value;
+        } else if (sscanf(line.c_str(), "Shared_Dirty: %ld kB", &value) == 1) {
+            detail.shared_dirty_kb = value;
+        } else if (sscanf(line.c_str(), "Private_Clean: %ld kB", &value) == 1) {
+            detail.private_clean_kb = value;
+        } else if (sscanf(line.c_str(), "Private_Dirty: %ld kB", &value) == 1) {
+            detail.private_dirty_kb = value;
+        } else if (sscanf(line.c_str(), "Swap: %ld kB", &value) == 1) {
+            detail.swap_kb = value;
+        }
+    }
+
+    // Kernel threads have an empty rollup
+    detail.valid = saw_pss;
+    detail.uss_kb = detail.private_clean_kb + detail.private_dirty_kb;
+    return detail;
+}
+
+void MemoryDetailCache::workerLoop() {
+    const auto refresh = chrono::milliseconds(refresh_ms);
+    unique_lock<mutex> lock(cache_mutex);
+
+    while (running) {
+        auto now = chrono::steady_clock::now();
+        has_new = false;
+
+        // Pick stale or missing entries; read them without holding the lock
+        vector<int> due;
+        for (int pid : wanted) {
+            auto it = cache.find(pid);
+            if (it == cache.end() || now - it->second.fetched_at >= refresh) {
+                due.push_back(pid);
+            }
+        }
+
+        // Forget rows that left the screen a while ago, so the cache stays
+        // proportional to the visible rows
+        for (auto it = cache.begin(); it != cache.end();) {
+            if (!wanted.count(it->first) && now - it->second.fetched_at >= 4 * refresh) {
+                it = cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (int pid : due) {
+            lock.unlock();
+            MemoryDetail detail = readSmapsRollup(pid);
+            lock.lock();
+            if (!running) return;
+            cache[pid] = detail;
+        }
+
+        wake.wait_for(lock, chrono::milliseconds(500),
+                       [this] { return !running || has_new; });
+    }
+}
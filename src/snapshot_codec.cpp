@@ -0,0 +1,259 @@
+#include "snapshot_codec.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+static const uint64_t kMaxStringLength = 4096;
+
+// Smallest encoded process: pid, three empty strings and three varints
+static const uint64_t kMinProcessBytes = 7;
+
+// Counts come off the wire, so vectors grow with what was actually parsed
+static const size_t kMaxReserve = 1024;
+
+static void putVarint(string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((char)((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back((char)value);
+}
+
+static void putString(string& out, const string& s) {
+    putVarint(out, s.size());
+    out.append(s);
+}
+
+static uint64_t toHundredths(double value) {
+    if (!(value > 0.0)) return 0;
+    return (uint64_t)llround(value * 100.0);
+}
+
+static uint64_t toUnsigned(long value) {
+    return value > 0 ? (uint64_t)value : 0;
+}
+
+static string frame(int type, const string& body) {
+    uint32_t len = (uint32_t)body.size() + 1;
+    string out;
+    out.reserve(SnapshotDecoder::kHeaderSize + len);
+    out.push_back((char)(len >> 24));
+    out.push_back((char)(len >> 16));
+    out.push_back((char)(len >> 8));
+    out.push_back((char)len);
+    out.push_back((char)type);
+    out.append(body);
+    return out;
+}
+
+static void putSystem(string& out, const SystemInfo& sys) {
+    putVarint(out, toHundredths(sys.cpu_usage));
+    putVarint(out, toUnsigned(sys.total_memory));
+    putVarint(out, toUnsigned(sys.used_memory));
+    putVarint(out, toUnsigned(sys.free_memory));
+    putVarint(out, toUnsigned(sys.running_processes));
+    putVarint(out, toUnsigned(sys.total_processes));
+}
+
+static void putProcess(string& out, const ProcessInfo& proc) {
+    putVarint(out, toUnsigned(proc.pid));
+    putString(out, proc.name);
+    putString(out, proc.user);
+    putString(out, proc.state);
+    putVarint(out, toUnsigned(proc.memory_kb));
+    putVarint(out, toHundredths(proc.cpu_usage));
+    putVarint(out, toHundredths(proc.memory_usage));
+}
+
+// Compares what actually goes on the wire, so sub-0.01% jitter is not resent
+static bool sameOnWire(const ProcessInfo& a, const ProcessInfo& b) {
+    return a.memory_kb == b.memory_kb &&
+           toHundredths(a.cpu_usage) == toHundredths(b.cpu_usage) &&
+           toHundredths(a.memory_usage) == toHundredths(b.memory_usage) &&
+           a.state == b.state &&
+           a.name == b.name &&
+           a.user == b.user;
+}
+
+class Reader {
+public:
+    Reader(const char* data, size_t len) : p(data), end(data + len) {}
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p == end) return false;
+            uint8_t byte = (uint8_t)*p++;
+            value |= (uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool str(string& s) {
+        uint64_t len;
+        if (!varint(len) || len > kMaxStringLength || len > (uint64_t)(end - p)) return false;
+        s.assign(p, (size_t)len);
+        p += len;
+        return true;
+    }
+
+    bool done() const { return p == end; }
+
+private:
+    const char* p;
+    const char* end;
+};
+
+static bool readSystem(Reader& r, SystemInfo& sys) {
+    uint64_t cpu, total, used, free_mem, running, count;
+    if (!r.varint(cpu) || !r.varint(total) || !r.varint(used) ||
+        !r.varint(free_mem) || !r.varint(running) || !r.varint(count)) {
+        return false;
+    }
+    sys.cpu_usage = cpu / 100.0;
+    sys.total_memory = (long)total;
+    sys.used_memory = (long)used;
+    sys.free_memory = (long)free_mem;
+    sys.running_processes = (int)running;
+    sys.total_processes = (int)count;
+    return true;
+}
+
+static bool readProcess(Reader& r, ProcessInfo& proc) {
+    uint64_t pid, memory_kb, cpu, mem;
+    if (!r.varint(pid) || !r.str(proc.name) || !r.str(proc.user) ||
+        !r.str(proc.state) || !r.varint(memory_kb) || !r.varint(cpu) || !r.varint(mem)) {
+        return false;
+    }
+    proc.pid = (int)pid;
+    proc.memory_kb = (long)memory_kb;
+    proc.cpu_usage = cpu / 100.0;
+    proc.memory_usage = mem / 100.0;
+    proc.cpu_jiffies = 0;
+    proc.cpu_p50 = proc.cpu_p95 = proc.cpu_p99 = proc.cpu_max = 0.0;
+    return true;
+}
+
+HostSnapshot::HostSnapshot() : has_full(false), system() {
+}
+
+SnapshotEncoder::SnapshotEncoder() : have_previous(false) {
+}
+
+string SnapshotEncoder::encodeHello(const string& host_name) {
+    string body;
+    putString(body, host_name.substr(0, kMaxStringLength));
+    return frame(FRAME_HELLO, body);
+}
+
+string SnapshotEncoder::encode(const SystemInfo& sys_info, const vector<ProcessInfo>& processes) {
+    string body;
+    putSystem(body, sys_info);
+
+    if (!have_previous) {
+        putVarint(body, processes.size());
+        previous.clear();
+        for (const auto& proc : processes) {
+            putProcess(body, proc);
+            previous[proc.pid] = proc;
+        }
+        have_previous = true;
+        return frame(FRAME_FULL, body);
+    }
+
+    unordered_map<int, ProcessInfo> current;
+    current.reserve(processes.size());
+    string changed;
+    uint64_t changed_count = 0;
+
+    for (const auto& proc : processes) {
+        auto it = previous.find(proc.pid);
+        if (it == previous.end() || !sameOnWire(it->second, proc)) {
+            putProcess(changed, proc);
+            changed_count++;
+            current[proc.pid] = proc;
+        } else {
+            // Keep what the collector has, so slow drift is eventually sent
+            current[proc.pid] = it->second;
+        }
+    }
+
+    string removed;
+    uint64_t removed_count = 0;
+    for (const auto& entry : previous) {
+        if (current.find(entry.first) == current.end()) {
+            putVarint(removed, toUnsigned(entry.first));
+            removed_count++;
+        }
+    }
+
+    putVarint(body, removed_count);
+    body.append(removed);
+    putVarint(body, changed_count);
+    body.append(changed);
+
+    previous.swap(current);
+    return frame(FRAME_DELTA, body);
+}
+
+void SnapshotEncoder::reset() {
+    have_previous = false;
+    previous.clear();
+}
+
+uint32_t SnapshotDecoder::frameLength(const char* header) {
+    const uint8_t* h = (const uint8_t*)header;
+    return ((uint32_t)h[0] << 24) | ((uint32_t)h[1] << 16) | ((uint32_t)h[2] << 8) | h[3];
+}
+
+bool SnapshotDecoder::decodeHello(const char* body, size_t len, string& host_name) {
+    Reader r(body, len);
+    return r.str(host_name) && !host_name.empty() && r.done();
+}
+
+bool SnapshotDecoder::apply(int type, const char* body, size_t len, HostSnapshot& snapshot) {
+    if (type != FRAME_FULL && type != FRAME_DELTA) return false;
+    if (type == FRAME_DELTA && !snapshot.has_full) return false;
+
+    Reader r(body, len);
+    SystemInfo sys = SystemInfo();
+    if (!readSystem(r, sys)) return false;
+
+    // Parse everything before touching the snapshot, so a truncated frame
+    // leaves it intact
+    vector<int> removed;
+    if (type == FRAME_DELTA) {
+        uint64_t removed_count;
+        if (!r.varint(removed_count) || removed_count > len) return false;
+        removed.reserve((size_t)min<uint64_t>(removed_count, kMaxReserve));
+        for (uint64_t i = 0; i < removed_count; i++) {
+            uint64_t pid;
+            if (!r.varint(pid)) return false;
+            removed.push_back((int)pid);
+        }
+    }
+
+    uint64_t count;
+    if (!r.varint(count) || count > len / kMinProcessBytes) return false;
+    vector<ProcessInfo> changed;
+    changed.reserve((size_t)min<uint64_t>(count, kMaxReserve));
+    for (uint64_t i = 0; i < count; i++) {
+        ProcessInfo proc;
+        if (!readProcess(r, proc)) return false;
+        changed.push_back(proc);
+    }
+    if (!r.done()) return false;
+
+    if (type == FRAME_FULL) snapshot.processes.clear();
+    for (int pid : removed) {
+        snapshot.processes.erase(pid);
+    }
+    for (const auto& proc : changed) {
+        snapshot.processes[proc.pid] = proc;
+    }
+    snapshot.system = sys;
+    snapshot.has_full = true;
+    return true;
+}
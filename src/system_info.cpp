@@ -8,9 +8,21 @@
 #include <sys/types.h>
 #include <signal.h>
 #include <string.h>
+#include <unordered_map>
 
 using namespace std;
 
+// Samples closer together than this reuse the previous CPU figures, so that
+// several getProcessList() calls within one refresh don't produce noisy
+// near-zero deltas. Measured in jiffies summed over all CPUs (~0.5s).
+static unsigned long long minSampleJiffies() {
+    long hz = sysconf(_SC_CLK_TCK);
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (hz <= 0) hz = 100;
+    if (cpus <= 0) cpus = 1;
+    return (unsigned long long)hz * cpus / 2;
+}
+
 SystemInfo SystemInfoReader::getSystemInfo() {
     SystemInfo info;
     
@@ -42,25 +54,73 @@ SystemInfo SystemInfoReader::getSystemInfo() {
         if (proc.state == "R") info.running_processes++;
     }
     
+    // Pressure stall information (Linux 4.20+)
+    info.cpu_pressure = getPressure("cpu");
+    info.memory_pressure = getPressure("memory");
+    info.io_pressure = getPressure("io");
+    
     return info;
 }
 
+PressureInfo SystemInfoReader::getPressure(const string& resource) {
+    PressureInfo pressure = {false, 0.0, 0.0};
+    ifstream pressure_file("/proc/pressure/" + resource);
+    string line;
+    
+    while (getline(pressure_file, line)) {
+        double avg10 = 0.0;
+        if (sscanf(line.c_str(), "some avg10=%lf", &avg10) == 1) {
+            pressure.some_avg10 = avg10;
+            pressure.available = true;
+        } else if (sscanf(line.c_str(), "full avg10=%lf", &avg10) == 1) {
+            pressure.full_avg10 = avg10;
+        }
+    }
+    return pressure;
+}
+
 double SystemInfoReader::calculateCPUUsage() {
+    static unsigned long long prev_total = 0;
+    static unsigned long long prev_idle = 0;
+    static double last_usage = 0.0;
+    
+    unsigned long long total_idle = 0;
+    unsigned long long total = readTotalJiffies(&total_idle);
+    if (total == 0) return 0.0;
+    
+    // First call: fall back to the since-boot average
+    if (prev_total == 0 || total < prev_total) {
+        prev_total = total;
+        prev_idle = total_idle;
+        last_usage = (double)(total - total_idle) / total * 100.0;
+        return last_usage;
+    }
+    
+    unsigned long long total_diff = total - prev_total;
+    if (total_diff < minSampleJiffies()) return last_usage;
+    
+    unsigned long long idle_diff = total_idle >= prev_idle ? total_idle - prev_idle : 0;
+    if (idle_diff > total_diff) idle_diff = total_diff;
+    last_usage = (double)(total_diff - idle_diff) / total_diff * 100.0;
+    
+    prev_total = total;
+    prev_idle = total_idle;
+    return last_usage;
+}
+
+unsigned long long SystemInfoReader::readTotalJiffies(unsigned long long* idle_jiffies) {
     ifstream statfile("/proc/stat");
     string line;
-    long user, nice, system, idle, iowait, irq, softirq, steal, guest, guest_nice;
+    unsigned long long user = 0, nice = 0, system = 0, idle = 0, iowait = 0;
+    unsigned long long irq = 0, softirq = 0, steal = 0;
     
     getline(statfile, line);
-    sscanf(line.c_str(), "cpu %ld %ld %ld %ld %ld %ld %ld %ld %ld %ld", 
-           &user, &nice, &system, &idle, &iowait, &irq, &softirq, &steal, &guest, &guest_nice);
-    
-    long total_idle = idle + iowait;
-    long total_non_idle = user + nice + system + irq + softirq + steal;
-    long total = total_idle + total_non_idle;
+    sscanf(line.c_str(), "cpu %llu %llu %llu %llu %llu %llu %llu %llu", 
+           &user, &nice, &system, &idle, &iowait, &irq, &softirq, &steal);
     
-    // Simple calculation - in real implementation, you'd compare with previous values
-    if (total == 0) return 0.0;
-    return (double)total_non_idle / total * 100.0;
+    // guest/guest_nice are already counted in user/nice
+    if (idle_jiffies) *idle_jiffies = idle + iowait;
+    return user + nice + system + idle + iowait + irq + softirq + steal;
 }
 
 long SystemInfoReader::getTotalMemory() {
@@ -99,9 +159,50 @@ vector<ProcessInfo> SystemInfoReader::getProcessList() {
     }
     
     closedir(proc_dir);
+    updateProcessCPUUsage(processes);
     return processes;
 }
 
+void SystemInfoReader::updateProcessCPUUsage(vector<ProcessInfo>& processes) {
+    struct CpuSample {
+        unsigned long long jiffies;
+        double usage;
+    };
+    static unordered_map<int, CpuSample> samples;
+    static unsigned long long baseline_total = 0;
+    
+    unsigned long long total = readTotalJiffies(nullptr);
+    bool first = baseline_total == 0 || total < baseline_total;
+    bool roll = first || total - baseline_total >= minSampleJiffies();
+    
+    if (!roll) {
+        for (auto& proc : processes) {
+            auto it = samples.find(proc.pid);
+            proc.cpu_usage = it != samples.end() ? it->second.usage : 0.0;
+        }
+        return;
+    }
+    
+    // Usage is a share of the whole machine, like memory_usage
+    unsigned long long total_diff = first ? 0 : total - baseline_total;
+    unordered_map<int, CpuSample> next;
+    next.reserve(processes.size());
+    
+    for (auto& proc : processes) {
+        auto it = samples.find(proc.pid);
+        proc.cpu_usage = 0.0;
+        if (total_diff > 0 && it != samples.end() && proc.cpu_jiffies >= it->second.jiffies) {
+            proc.cpu_usage = (double)(proc.cpu_jiffies - it->second.jiffies) / total_diff * 100.0;
+            if (proc.cpu_usage > 100.0) proc.cpu_usage = 100.0;
+        }
+        next[proc.pid] = CpuSample{proc.cpu_jiffies, proc.cpu_usage};
+    }
+    
+    // Rebuilding the map drops exited PIDs
+    samples.swap(next);
+    baseline_total = total;
+}
+
 ProcessInfo SystemInfoReader::getProcessInfo(int pid) {
     ProcessInfo proc;
     proc.pid = -1; // Mark as invalid initially
@@ -114,30 +215,34 @@ ProcessInfo SystemInfoReader::getProcessInfo(int pid) {
     string line;
     getline(statfile, line);
     
-    istringstream iss(line);
+    // comm may contain spaces or parentheses, so split only after the last ')'
+    size_t name_start = line.find('(');
+    size_t name_end = line.rfind(')');
+    if (name_start == string::npos || name_end == string::npos || name_end < name_start) return proc;
+    
+    istringstream iss(line.substr(name_end + 1));
     string token;
-    vector<string> tokens;
+    vector<string> tokens; // tokens[0] is field 3 (state)
     
-    while (getline(iss, token, ' ')) {
+    while (iss >> token) {
         tokens.push_back(token);
     }
     
-    if (tokens.size() < 24) return proc;
+    if (tokens.size() < 22) return proc;
     
     proc.pid = pid;
-    proc.name = tokens[1];
-    if (proc.name.length() > 2 && proc.name[0] == '(' && proc.name.back() == ')') {
-        proc.name = proc.name.substr(1, proc.name.length() - 2);
-    }
-    proc.state = tokens[2];
+    proc.name = line.substr(name_start + 1, name_end - name_start - 1);
+    proc.state = tokens[0];
     
     // Get memory usage
-    long rss_pages = stol(tokens[23]);
+    long rss_pages = stol(tokens[21]);
     proc.memory_kb = rss_pages * sysconf(_SC_PAGE_SIZE) / 1024;
     proc.memory_usage = (double)proc.memory_kb / getTotalMemory() * 100.0;
     
-    // Simple CPU usage calculation (you'd need more sophisticated tracking for real usage)
-    proc.cpu_usage = 0.0; // Simplified
+    // Raw utime + stime; turned into a percentage by updateProcessCPUUsage()
+    proc.cpu_jiffies = stoull(tokens[11]) + stoull(tokens[12]);
+    proc.cpu_usage = 0.0;
+    proc.cpu_p50 = proc.cpu_p95 = proc.cpu_p99 = proc.cpu_max = 0.0;
     
     proc.user = getProcessUser(pid);
     
@@ -5,12 +5,43 @@ cat > ui_manager.cpp << 'ENHANCED_UI'
 #include <sstream>
 #include <vector>
 #include <cstddef>
+#include <cstdarg>
+#include <cstdio>
 
 
 using namespace std;
 
-UIManager::UIManager() : current_sort(SORT_CPU), sort_descending(true), 
-                        selected_process(0), should_exit(false) {
+// Smart memory display
+static string formatMemory(long kb) {
+    char buffer[20];
+    if (kb < 1024) {
+        return to_string(kb) + " KB";
+    } else if (kb < 1024 * 1024) {
+        snprintf(buffer, sizeof(buffer), "%.1f MB", kb / 1024.0);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%.1f GB", kb / (1024.0 * 1024.0));
+    }
+    return buffer;
+}
+
+// Like mvwprintw, but never wraps past the right edge of the window
+static void printClipped(WINDOW* win, int row, int x, const char* fmt, ...) {
+    int room = getmaxx(win) - x;
+    if (room <= 0) return;
+    
+    char buffer[512];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    mvwaddnstr(win, row, x, buffer, room);
+}
+
+UIManager::UIManager(MonitorCollector* collector, const UsageStatsTracker& usage_stats)
+    : current_sort(SORT_CPU), sort_descending(true), 
+      selected_process(0), should_exit(false), usage_stats(usage_stats),
+      stats_window(0), collector(collector),
+      selected_pid(-1) {
 }
 
 UIManager::~UIManager() {
@@ -37,18 +68,44 @@ void UIManager::initializeUI() {
     int height, width;
     getmaxyx(stdscr, height, width);
     main_win = newwin(height, width, 0, 0);
+    
+    // smaps_rollup is only readable for local processes
+    if (!collector) memory_details.start();
 }
 
 void UIManager::mainLoop() {
     while (!should_exit) {
         werase(main_win);
         
+        // Collector mode: host summary list until a host is picked
+        if (collector && current_host.empty()) {
+            vector<HostSummary> hosts = collector->hostSummaries();
+            drawHostSummary(hosts);
+            drawHostList(hosts);
+            drawFooter();
+            
+            wrefresh(main_win);
+            handleInput();
+            continue;
+        }
+        
         // Get system info
-        SystemInfo sys_info = SystemInfoReader::getSystemInfo();
-        vector<ProcessInfo> processes = SystemInfoReader::getProcessList();
+        SystemInfo sys_info = SystemInfo();
+        vector<ProcessInfo> processes;
+        if (collector) {
+            collector->hostSnapshot(current_host, sys_info, processes);
+        } else {
+            sys_info = SystemInfoReader::getSystemInfo();
+            processes = SystemInfoReader::getProcessList();
+            
+            // Feed the sliding-window percentiles
+            usage_stats.record(sys_info, processes);
+            usage_stats.annotate(processes, stats_window);
+        }
         
         // Sort processes
         processes = sortProcesses(processes);
+        if (!collector) requestMemoryDetails(processes);
         
         // Draw UI
         drawHeader(sys_info);
@@ -63,7 +120,12 @@ void UIManager::mainLoop() {
 void UIManager::drawHeader(const SystemInfo& sys_info) {
     wattron(main_win, A_BOLD);
     wattron(main_win, COLOR_PAIR(4));
-    mvwprintw(main_win, 0, 0, " 🚀 SYSTEM MONITOR - Press 'q' to quit | 'k' to kill process ");
+    if (collector) {
+        mvwprintw(main_win, 0, 0, " 🚀 SYSTEM MONITOR - 🌐 %s - Press 'b' for host list | 'q' to quit ",
+                 current_host.c_str());
+    } else {
+        mvwprintw(main_win, 0, 0, " 🚀 SYSTEM MONITOR - Press 'q' to quit | 'k' to kill process ");
+    }
     wattroff(main_win, COLOR_PAIR(4));
     wattroff(main_win, A_BOLD);
     
@@ -76,13 +138,22 @@ void UIManager::drawHeader(const SystemInfo& sys_info) {
     } else {
         wattron(main_win, COLOR_PAIR(2));
     }
-    mvwprintw(main_win, 1, 0, "💻 CPU Usage: %.1f%%", sys_info.cpu_usage);
+    if (collector) {
+        // Percentiles are only tracked for the local host
+        mvwprintw(main_win, 1, 0, "💻 CPU Usage: %.1f%%", sys_info.cpu_usage);
+    } else {
+        PercentileSummary cpu_stats = usage_stats.systemSummary(stats_window);
+        printClipped(main_win, 1, 0, "💻 CPU Usage: %.1f%%  [%s p50 %.1f | p95 %.1f | p99 %.1f | max %.1f]",
+                 sys_info.cpu_usage, usage_stats.windowLabel(stats_window).c_str(),
+                 cpu_stats.p50, cpu_stats.p95, cpu_stats.p99, cpu_stats.max);
+    }
     wattroff(main_win, COLOR_PAIR(1));
     wattroff(main_win, COLOR_PAIR(2));
     wattroff(main_win, COLOR_PAIR(3));
     
     // Memory usage with color coding
-    double memory_percent = (double)sys_info.used_memory / sys_info.total_memory * 100.0;
+    double memory_percent = sys_info.total_memory > 0
+        ? (double)sys_info.used_memory / sys_info.total_memory * 100.0 : 0.0;
     wattron(main_win, A_BOLD);
     if (memory_percent > 85) {
         wattron(main_win, COLOR_PAIR(1));
@@ -105,6 +176,26 @@ void UIManager::drawHeader(const SystemInfo& sys_info) {
     mvwprintw(main_win, 3, 0, "📊 Processes: %d total, %d running", 
              sys_info.total_processes, sys_info.running_processes);
     wattroff(main_win, COLOR_PAIR(4));
+    
+    // Pressure stalls (some/full avg10) next to the process count
+    if (!collector && sys_info.memory_pressure.available) {
+        double worst = max(sys_info.cpu_pressure.some_avg10,
+                           max(sys_info.memory_pressure.some_avg10, sys_info.io_pressure.some_avg10));
+        if (worst > 25) {
+            wattron(main_win, COLOR_PAIR(1));
+        } else if (worst > 5) {
+            wattron(main_win, COLOR_PAIR(3));
+        } else {
+            wattron(main_win, COLOR_PAIR(2));
+        }
+        printClipped(main_win, 3, getcurx(main_win), "  |  ⏳ Pressure: CPU %.1f%% | MEM %.1f/%.1f%% | IO %.1f/%.1f%%",
+                sys_info.cpu_pressure.some_avg10,
+                sys_info.memory_pressure.some_avg10, sys_info.memory_pressure.full_avg10,
+                sys_info.io_pressure.some_avg10, sys_info.io_pressure.full_avg10);
+        wattroff(main_win, COLOR_PAIR(1));
+        wattroff(main_win, COLOR_PAIR(2));
+        wattroff(main_win, COLOR_PAIR(3));
+    }
              
     // Separator
     wattron(main_win, COLOR_PAIR(4));
@@ -112,22 +203,88 @@ void UIManager::drawHeader(const SystemInfo& sys_info) {
     wattroff(main_win, COLOR_PAIR(4));
 }
 
+// Process list columns, left to right
+enum ProcessColumn {
+    COL_PID, COL_USER, COL_CPU, COL_P50, COL_P95, COL_P99, COL_MAX,
+    COL_MEM, COL_RSS, COL_PSS, COL_USS, COL_SWAP, COL_STATE, COL_COMMAND,
+    COL_COUNT
+};
+
+struct ColumnSpec {
+    const char* label;
+    int width;
+    bool optional;
+};
+
+static const ColumnSpec kColumns[COL_COUNT] = {
+    {"PID", 8, false}, {"USER", 14, false}, {"CPU%", 8, false},
+    {"P50", 6, true}, {"P95", 6, true}, {"P99", 6, true}, {"MAX", 6, true},
+    {"MEM%", 8, false}, {"RSS", 14, false},
+    {"PSS", 11, true}, {"USS", 11, true}, {"SWAP", 11, true},
+    {"STATE", 8, false}, {"COMMAND", 0, false}
+};
+
+// Optional columns, most useful first; the tail is dropped on narrow terminals
+static const ProcessColumn kOptionalOrder[] = {
+    COL_P95, COL_PSS, COL_MAX, COL_P99, COL_USS, COL_SWAP, COL_P50
+};
+
+static const int kMinCommandWidth = 16;
+
+// Fills col_x with each column's x position, or -1 if it doesn't fit.
+// The column of the active sort key is kept first so sorting stays visible.
+// The optional columns are all local-only metrics, so a drilled-in
+// collector host gets just the baseline columns.
+static void layoutColumns(int width, SortType sort, bool local_metrics, int col_x[COL_COUNT]) {
+    bool shown[COL_COUNT];
+    int used = 0;
+    for (int c = 0; c < COL_COUNT; c++) {
+        shown[c] = !kColumns[c].optional;
+        if (shown[c]) used += kColumns[c].width;
+    }
+    
+    vector<ProcessColumn> order;
+    if (sort == SORT_CPU_P50) order.push_back(COL_P50);
+    if (sort == SORT_CPU_P95) order.push_back(COL_P95);
+    if (sort == SORT_CPU_P99) order.push_back(COL_P99);
+    if (sort == SORT_CPU_MAX) order.push_back(COL_MAX);
+    order.insert(order.end(), begin(kOptionalOrder), end(kOptionalOrder));
+    
+    for (ProcessColumn c : order) {
+        if (local_metrics && !shown[c] && used + kColumns[c].width + kMinCommandWidth <= width) {
+            shown[c] = true;
+            used += kColumns[c].width;
+        }
+    }
+    
+    int x = 0;
+    for (int c = 0; c < COL_COUNT; c++) {
+        col_x[c] = shown[c] ? x : -1;
+        if (shown[c]) x += kColumns[c].width;
+    }
+}
+
 void UIManager::drawProcessList(const vector<ProcessInfo>& processes) {
+    int col_x[COL_COUNT];
+    layoutColumns(getmaxx(main_win), current_sort, collector == nullptr, col_x);
+    
     // Column headers
     wattron(main_win, A_BOLD | A_REVERSE);
     wattron(main_win, COLOR_PAIR(4));
-    mvwprintw(main_win, 5, 0, " PID   ");
-    mvwprintw(main_win, 5, 8, " USER         ");
-    mvwprintw(main_win, 5, 22, " CPU%%  ");
-    mvwprintw(main_win, 5, 30, " MEM%%  ");
-    mvwprintw(main_win, 5, 38, " MEMORY      ");
-    mvwprintw(main_win, 5, 52, " STATE ");
-    mvwprintw(main_win, 5, 60, " COMMAND");
+    for (int c = 0; c < COL_COUNT; c++) {
+        if (col_x[c] < 0) continue;
+        if (c == COL_COMMAND) {
+            printClipped(main_win, 5, col_x[c], " %s", kColumns[c].label);
+        } else {
+            printClipped(main_win, 5, col_x[c], " %-*s", kColumns[c].width - 1, kColumns[c].label);
+        }
+    }
     wattroff(main_win, COLOR_PAIR(4));
     wattroff(main_win, A_BOLD | A_REVERSE);
     
     int max_rows = getmaxy(main_win) - 8;
     int display_count = min((int)processes.size(), max_rows);
+    selected_pid = selected_process < (int)processes.size() ? processes[selected_process].pid : -1;
     
     for (int i = 0; i < display_count; i++) {
         const ProcessInfo& proc = processes[i];
@@ -140,14 +297,14 @@ void UIManager::drawProcessList(const vector<ProcessInfo>& processes) {
         }
         
         // PID
-        mvwprintw(main_win, row, 0, " %-5d", proc.pid);
+        printClipped(main_win, row, col_x[COL_PID], " %-5d", proc.pid);
         
         // User (truncate if too long)
         string user_display = proc.user;
         if (user_display.length() > 12) {
             user_display = user_display.substr(0, 9) + "...";
         }
-        mvwprintw(main_win, row, 8, " %-12s", user_display.c_str());
+        printClipped(main_win, row, col_x[COL_USER], " %-12s", user_display.c_str());
         
         // CPU with color
         if (proc.cpu_usage > 50) {
@@ -155,36 +312,44 @@ void UIManager::drawProcessList(const vector<ProcessInfo>& processes) {
         } else if (proc.cpu_usage > 20) {
             wattron(main_win, COLOR_PAIR(3));
         }
-        mvwprintw(main_win, row, 22, " %5.1f", proc.cpu_usage);
+        printClipped(main_win, row, col_x[COL_CPU], " %5.1f", proc.cpu_usage);
         wattroff(main_win, COLOR_PAIR(1));
         wattroff(main_win, COLOR_PAIR(3));
         
+        // Windowed CPU percentiles
+        if (col_x[COL_P50] >= 0) printClipped(main_win, row, col_x[COL_P50], " %5.1f", proc.cpu_p50);
+        if (col_x[COL_P95] >= 0) printClipped(main_win, row, col_x[COL_P95], " %5.1f", proc.cpu_p95);
+        if (col_x[COL_P99] >= 0) printClipped(main_win, row, col_x[COL_P99], " %5.1f", proc.cpu_p99);
+        if (col_x[COL_MAX] >= 0) printClipped(main_win, row, col_x[COL_MAX], " %5.1f", proc.cpu_max);
+        
         // Memory with color
         if (proc.memory_usage > 10) {
             wattron(main_win, COLOR_PAIR(1));
         } else if (proc.memory_usage > 5) {
             wattron(main_win, COLOR_PAIR(3));
         }
-        mvwprintw(main_win, row, 30, " %5.1f", proc.memory_usage);
+        printClipped(main_win, row, col_x[COL_MEM], " %5.1f", proc.memory_usage);
         wattroff(main_win, COLOR_PAIR(1));
         wattroff(main_win, COLOR_PAIR(3));
         
-        // Smart memory display
-        string mem_display;
-        if (proc.memory_kb < 1024) {
-            mem_display = to_string(proc.memory_kb) + " KB";
-        } else if (proc.memory_kb < 1024 * 1024) {
-            double mb = proc.memory_kb / 1024.0;
-            char buffer[20];
-            snprintf(buffer, sizeof(buffer), "%.1f MB", mb);
-            mem_display = buffer;
-        } else {
-            double gb = proc.memory_kb / (1024.0 * 1024.0);
-            char buffer[20];
-            snprintf(buffer, sizeof(buffer), "%.1f GB", gb);
-            mem_display = buffer;
+        printClipped(main_win, row, col_x[COL_RSS], " %-11s", formatMemory(proc.memory_kb).c_str());
+        
+        // Deep memory metrics, from the background smaps_rollup cache.
+        // "..." = not fetched yet, "-" = unreadable (other user, kernel thread)
+        if (col_x[COL_PSS] >= 0 || col_x[COL_USS] >= 0 || col_x[COL_SWAP] >= 0) {
+            MemoryDetail detail;
+            string pss_display = "-", uss_display = "-", swap_display = "-";
+            if (!memory_details.lookup(proc.pid, detail)) {
+                pss_display = uss_display = swap_display = "...";
+            } else if (detail.valid) {
+                pss_display = formatMemory(detail.pss_kb);
+                uss_display = formatMemory(detail.uss_kb);
+                swap_display = formatMemory(detail.swap_kb);
+            }
+            if (col_x[COL_PSS] >= 0) printClipped(main_win, row, col_x[COL_PSS], " %-10s", pss_display.c_str());
+            if (col_x[COL_USS] >= 0) printClipped(main_win, row, col_x[COL_USS], " %-10s", uss_display.c_str());
+            if (col_x[COL_SWAP] >= 0) printClipped(main_win, row, col_x[COL_SWAP], " %-10s", swap_display.c_str());
         }
-        mvwprintw(main_win, row, 38, " %-11s", mem_display.c_str());
         
         // State with emoji
         string state_display;
@@ -194,15 +359,155 @@ void UIManager::drawProcessList(const vector<ProcessInfo>& processes) {
         else state_display = "❓";
         state_display += proc.state;
         
-        mvwprintw(main_win, row, 52, " %-6s", state_display.c_str());
+        printClipped(main_win, row, col_x[COL_STATE], " %-6s", state_display.c_str());
         
         // Command name
         string name_display = proc.name;
-        int max_name_width = getmaxx(main_win) - 61;
-        if (name_display.length() > max_name_width) {
+        int max_name_width = max(4, getmaxx(main_win) - col_x[COL_COMMAND] - 1);
+        if ((int)name_display.length() > max_name_width) {
             name_display = name_display.substr(0, max_name_width - 3) + "...";
         }
-        mvwprintw(main_win, row, 60, " %s", name_display.c_str());
+        printClipped(main_win, row, col_x[COL_COMMAND], " %s", name_display.c_str());
+        
+        if (i == selected_process) {
+            wattroff(main_win, COLOR_PAIR(5));
+            wattroff(main_win, A_BOLD);
+        }
+    }
+}
+
+void UIManager::requestMemoryDetails(const vector<ProcessInfo>& processes) {
+    // Only rows on screen plus the selection are worth an smaps_rollup read
+    int max_rows = getmaxy(main_win) - 8;
+    int display_count = min((int)processes.size(), max_rows);
+    
+    vector<int> pids;
+    pids.reserve(display_count + 1);
+    for (int i = 0; i < display_count; i++) {
+        pids.push_back(processes[i].pid);
+    }
+    if (selected_process >= display_count && selected_process < (int)processes.size()) {
+        pids.push_back(processes[selected_process].pid);
+    }
+    memory_details.request(pids);
+}
+
+void UIManager::drawHostSummary(const vector<HostSummary>& hosts) {
+    wattron(main_win, A_BOLD);
+    wattron(main_win, COLOR_PAIR(4));
+    mvwprintw(main_win, 0, 0, " 🚀 SYSTEM MONITOR - 🌐 Collector - Press 'Enter' to open a host | 'q' to quit ");
+    wattroff(main_win, COLOR_PAIR(4));
+    wattroff(main_win, A_BOLD);
+    
+    int connected = 0;
+    int total_processes = 0;
+    double cpu_sum = 0.0;
+    long used_memory = 0, total_memory = 0;
+    for (const auto& host : hosts) {
+        if (host.connected) connected++;
+        total_processes += host.system.total_processes;
+        cpu_sum += host.system.cpu_usage;
+        used_memory += host.system.used_memory;
+        total_memory += host.system.total_memory;
+    }
+    
+    wattron(main_win, A_BOLD);
+    wattron(main_win, COLOR_PAIR(connected == (int)hosts.size() ? 2 : 3));
+    mvwprintw(main_win, 1, 0, "🌐 Hosts: %d total, %d connected", (int)hosts.size(), connected);
+    wattroff(main_win, COLOR_PAIR(2));
+    wattroff(main_win, COLOR_PAIR(3));
+    wattroff(main_win, A_BOLD);
+    
+    mvwprintw(main_win, 2, 0, "💻 Avg CPU: %.1f%% | 💾 Memory: %.1fGB / %.1fGB",
+             hosts.empty() ? 0.0 : cpu_sum / hosts.size(),
+             used_memory / 1024.0 / 1024.0,
+             total_memory / 1024.0 / 1024.0);
+    
+    wattron(main_win, COLOR_PAIR(4));
+    mvwprintw(main_win, 3, 0, "📊 Processes: %d across all hosts", total_processes);
+    wattroff(main_win, COLOR_PAIR(4));
+    
+    // Separator
+    wattron(main_win, COLOR_PAIR(4));
+    mvwhline(main_win, 4, 0, '=', getmaxx(main_win));
+    wattroff(main_win, COLOR_PAIR(4));
+}
+
+void UIManager::drawHostList(const vector<HostSummary>& hosts) {
+    // Column headers; AGE ends at column 80 and wider cells are clipped
+    wattron(main_win, A_BOLD | A_REVERSE);
+    wattron(main_win, COLOR_PAIR(4));
+    printClipped(main_win, 5, 0, " HOST                    ");
+    printClipped(main_win, 5, 26, " STATUS ");
+    printClipped(main_win, 5, 35, " CPU%%  ");
+    printClipped(main_win, 5, 43, " MEM%%  ");
+    printClipped(main_win, 5, 51, " MEMORY          ");
+    printClipped(main_win, 5, 69, " PROCS ");
+    printClipped(main_win, 5, 76, " AGE");
+    wattroff(main_win, COLOR_PAIR(4));
+    wattroff(main_win, A_BOLD | A_REVERSE);
+    
+    if (selected_process >= (int)hosts.size()) {
+        selected_process = hosts.empty() ? 0 : (int)hosts.size() - 1;
+    }
+    
+    int max_rows = getmaxy(main_win) - 8;
+    int display_count = min((int)hosts.size(), max_rows);
+    
+    for (int i = 0; i < display_count; i++) {
+        const HostSummary& host = hosts[i];
+        int row = 6 + i;
+        
+        // Highlight selected host
+        if (i == selected_process) {
+            wattron(main_win, COLOR_PAIR(5));
+            wattron(main_win, A_BOLD);
+        }
+        
+        string name_display = host.name;
+        if (name_display.length() > 24) {
+            name_display = name_display.substr(0, 21) + "...";
+        }
+        printClipped(main_win, row, 0, " %-24s", name_display.c_str());
+        
+        if (!host.connected) wattron(main_win, COLOR_PAIR(1));
+        printClipped(main_win, row, 26, " %-7s", host.connected ? "up" : "down");
+        wattroff(main_win, COLOR_PAIR(1));
+        
+        // CPU with color
+        if (host.system.cpu_usage > 80) {
+            wattron(main_win, COLOR_PAIR(1));
+        } else if (host.system.cpu_usage > 60) {
+            wattron(main_win, COLOR_PAIR(3));
+        }
+        printClipped(main_win, row, 35, " %5.1f", host.system.cpu_usage);
+        wattroff(main_win, COLOR_PAIR(1));
+        wattroff(main_win, COLOR_PAIR(3));
+        
+        double memory_percent = host.system.total_memory > 0
+            ? (double)host.system.used_memory / host.system.total_memory * 100.0 : 0.0;
+        if (memory_percent > 85) {
+            wattron(main_win, COLOR_PAIR(1));
+        } else if (memory_percent > 70) {
+            wattron(main_win, COLOR_PAIR(3));
+        }
+        printClipped(main_win, row, 43, " %5.1f", memory_percent);
+        wattroff(main_win, COLOR_PAIR(1));
+        wattroff(main_win, COLOR_PAIR(3));
+        
+        char mem_display[32];
+        snprintf(mem_display, sizeof(mem_display), "%.1f/%.1f GB",
+                 host.system.used_memory / 1024.0 / 1024.0,
+                 host.system.total_memory / 1024.0 / 1024.0);
+        printClipped(main_win, row, 51, " %-16s", mem_display);
+        
+        printClipped(main_win, row, 69, " %-5d", host.system.total_processes);
+        
+        if (host.seconds_since_update < 0) {
+            printClipped(main_win, row, 76, " -");
+        } else {
+            printClipped(main_win, row, 76, " %.0fs", host.seconds_since_update);
+        }
         
         if (i == selected_process) {
             wattroff(main_win, COLOR_PAIR(5));
@@ -217,14 +522,42 @@ void UIManager::drawFooter() {
     // Separator
     wattron(main_win, COLOR_PAIR(4));
     mvwhline(main_win, height - 2, 0, '=', getmaxx(main_win));
+    
+    // Shared/private breakdown for the selected process
+    MemoryDetail detail;
+    if (!collector && selected_pid > 0 &&
+        memory_details.lookup(selected_pid, detail) && detail.valid) {
+        long age = (long)chrono::duration_cast<chrono::seconds>(
+            chrono::steady_clock::now() - detail.fetched_at).count();
+        printClipped(main_win, height - 2, 2,
+                 " PID %d | PSS %s | USS %s | Shared %s clean, %s dirty | Private %s clean, %s dirty | Swap %s | %lds ago ",
+                 selected_pid,
+                 formatMemory(detail.pss_kb).c_str(),
+                 formatMemory(detail.uss_kb).c_str(),
+                 formatMemory(detail.shared_clean_kb).c_str(),
+                 formatMemory(detail.shared_dirty_kb).c_str(),
+                 formatMemory(detail.private_clean_kb).c_str(),
+                 formatMemory(detail.private_dirty_kb).c_str(),
+                 formatMemory(detail.swap_kb).c_str(),
+                 age);
+    }
     wattroff(main_win, COLOR_PAIR(4));
     
     // Footer with instructions
     wattron(main_win, A_BOLD);
     wattron(main_win, COLOR_PAIR(3));
     
-    mvwprintw(main_win, height - 1, 0, 
-             "🛠️ Sort: F1(CPU) F2(MEM) F3(PID) | 🔥 Kill: k | 🚪 Quit: q");
+    if (collector && current_host.empty()) {
+        mvwprintw(main_win, height - 1, 0, 
+                 "🌐 Open host: Enter | 🚪 Quit: q");
+    } else if (collector) {
+        mvwprintw(main_win, height - 1, 0, 
+                 "🛠️ Sort: F1(CPU) F2(MEM) F3(PID) | 🌐 Hosts: b | 🚪 Quit: q");
+    } else {
+        printClipped(main_win, height - 1, 0, 
+                 "🛠️ Sort: F1(CPU) F2(MEM) F3(PID) F5(P50) F6(P95) F7(P99) F8(MAX) | ⏱️ Window: w (%s) | 🔥 Kill: k | 🚪 Quit: q",
+                 usage_stats.windowLabel(stats_window).c_str());
+    }
     
     wattroff(main_win, COLOR_PAIR(3));
     wattroff(main_win, A_BOLD);
@@ -244,16 +577,32 @@ void UIManager::handleInput() {
         case KEY_DOWN:
             selected_process++;
             break;
-        case 'k':
-        case 'K': {
-            auto processes = SystemInfoReader::getProcessList();
-            processes = sortProcesses(processes);
-            if (selected_process < processes.size()) {
-                int pid_to_kill = processes[selected_process].pid;
-                SystemInfoReader::killProcess(pid_to_kill);
+        case '\n':
+        case KEY_ENTER:
+            if (collector && current_host.empty()) {
+                auto hosts = collector->hostSummaries();
+                if (selected_process < (int)hosts.size()) {
+                    current_host = hosts[selected_process].name;
+                    selected_process = 0;
+                }
             }
             break;
-        }
+        case 'b':
+        case 'B':
+        case 27: // Esc
+        case KEY_BACKSPACE:
+            if (collector && !current_host.empty()) {
+                current_host.clear();
+                selected_process = 0;
+            }
+            break;
+        case 'k':
+        case 'K':
+            // Only local processes can be killed. Use the PID that was on
+            // screen: a fresh, re-sorted list may have a different order.
+            if (collector) break;
+            if (selected_pid > 0) SystemInfoReader::killProcess(selected_pid);
+            break;
         case KEY_F(1):
             current_sort = SORT_CPU;
             sort_descending = true;
@@ -269,6 +618,36 @@ void UIManager::handleInput() {
             sort_descending = false;
             selected_process = 0;
             break;
+        case KEY_F(5):
+            // Percentiles are only tracked for local processes
+            if (collector) break;
+            current_sort = SORT_CPU_P50;
+            sort_descending = true;
+            selected_process = 0;
+            break;
+        case KEY_F(6):
+            if (collector) break;
+            current_sort = SORT_CPU_P95;
+            sort_descending = true;
+            selected_process = 0;
+            break;
+        case KEY_F(7):
+            if (collector) break;
+            current_sort = SORT_CPU_P99;
+            sort_descending = true;
+            selected_process = 0;
+            break;
+        case KEY_F(8):
+            if (collector) break;
+            current_sort = SORT_CPU_MAX;
+            sort_descending = true;
+            selected_process = 0;
+            break;
+        case 'w':
+        case 'W':
+            if (collector) break;
+            stats_window = (stats_window + 1) % SlidingPercentiles::kNumWindows;
+            break;
     }
 }
 
@@ -298,6 +677,30 @@ vector<ProcessInfo> UIManager::sortProcesses(vector<ProcessInfo> processes) {
                      return a.name < b.name;
                  });
             break;
+        case SORT_CPU_P50:
+            sort(processes.begin(), processes.end(), 
+                 [](const ProcessInfo& a, const ProcessInfo& b) {
+                     return a.cpu_p50 > b.cpu_p50;
+                 });
+            break;
+        case SORT_CPU_P95:
+            sort(processes.begin(), processes.end(), 
+                 [](const ProcessInfo& a, const ProcessInfo& b) {
+                     return a.cpu_p95 > b.cpu_p95;
+                 });
+            break;
+        case SORT_CPU_P99:
+            sort(processes.begin(), processes.end(), 
+                 [](const ProcessInfo& a, const ProcessInfo& b) {
+                     return a.cpu_p99 > b.cpu_p99;
+                 });
+            break;
+        case SORT_CPU_MAX:
+            sort(processes.begin(), processes.end(), 
+                 [](const ProcessInfo& a, const ProcessInfo& b) {
+                     return a.cpu_max > b.cpu_max;
+                 });
+            break;
     }
     
     return processes;
@@ -0,0 +1,158 @@
+#include "usage_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+static int samplesFor(int window_sec, int interval_ms) {
+    if (interval_ms <= 0) interval_ms = 1000;
+    long samples = (long)window_sec * 1000 / interval_ms;
+    if (samples < 1) samples = 1;
+    if (samples > 65535) samples = 65535;
+    return (int)samples;
+}
+
+SlidingPercentiles::SlidingPercentiles(const int (&window_samples)[kNumWindows])
+    : head(0), filled(0) {
+    for (int i = 0; i < kNumWindows; i++) {
+        windows[i] = window_samples[i];
+    }
+    ring.assign(*max_element(windows, windows + kNumWindows), 0);
+    memset(counts, 0, sizeof(counts));
+}
+
+int SlidingPercentiles::bucketFor(double value) {
+    if (!(value > 0.0)) return 0;
+    if (value <= 1.0) return max(1, (int)ceil(value * 10.0 - 1e-9));
+    if (value <= 10.0) return 10 + (int)ceil((value - 1.0) * 2.0 - 1e-9);
+    if (value >= 100.0) return kNumBuckets - 1;
+    return 28 + (int)ceil((value - 10.0) / 2.5 - 1e-9);
+}
+
+double SlidingPercentiles::bucketValue(int bucket) {
+    if (bucket <= 10) return bucket * 0.1;
+    if (bucket <= 28) return 1.0 + (bucket - 10) * 0.5;
+    return 10.0 + (bucket - 28) * 2.5;
+}
+
+void SlidingPercentiles::add(double value) {
+    int capacity = (int)ring.size();
+
+    // Expire the sample that falls out of each window. For the longest
+    // window that is the slot about to be overwritten.
+    for (int i = 0; i < kNumWindows; i++) {
+        if (filled >= windows[i]) {
+            int old = (head + capacity - windows[i]) % capacity;
+            counts[i][ring[old]]--;
+        }
+    }
+
+    uint8_t bucket = (uint8_t)bucketFor(value);
+    ring[head] = bucket;
+    head = (head + 1) % capacity;
+    if (filled < capacity) filled++;
+
+    for (int i = 0; i < kNumWindows; i++) {
+        counts[i][bucket]++;
+    }
+}
+
+double SlidingPercentiles::percentile(int window, double q) const {
+    int n = min(filled, windows[window]);
+    if (n == 0) return 0.0;
+
+    int rank = max(1, (int)ceil(q * n));
+    int seen = 0;
+    for (int b = 0; b < kNumBuckets; b++) {
+        seen += counts[window][b];
+        if (seen >= rank) return bucketValue(b);
+    }
+    return bucketValue(kNumBuckets - 1);
+}
+
+PercentileSummary SlidingPercentiles::summary(int window) const {
+    PercentileSummary s = {0.0, 0.0, 0.0, 0.0};
+    if (window < 0 || window >= kNumWindows) return s;
+
+    s.p50 = percentile(window, 0.50);
+    s.p95 = percentile(window, 0.95);
+    s.p99 = percentile(window, 0.99);
+    for (int b = kNumBuckets - 1; b >= 0; b--) {
+        if (counts[window][b] > 0) {
+            s.max = bucketValue(b);
+            break;
+        }
+    }
+    return s;
+}
+
+UsageStatsTracker::UsageStatsTracker(int sample_interval_ms,
+                                     int window_1_sec,
+                                     int window_2_sec,
+                                     int window_3_sec)
+    : sample_interval_ms(sample_interval_ms > 0 ? sample_interval_ms : 1000),
+      window_seconds{window_1_sec, window_2_sec, window_3_sec},
+      window_samples{samplesFor(window_1_sec, sample_interval_ms),
+                     samplesFor(window_2_sec, sample_interval_ms),
+                     samplesFor(window_3_sec, sample_interval_ms)},
+      sample_count(0),
+      system_cpu(window_samples) {
+}
+
+bool UsageStatsTracker::record(const SystemInfo& sys_info, const vector<ProcessInfo>& processes) {
+    auto now = chrono::steady_clock::now();
+    if (sample_count > 0 &&
+        now - last_sample < chrono::milliseconds(sample_interval_ms)) {
+        return false;
+    }
+    last_sample = now;
+    sample_count++;
+
+    system_cpu.add(sys_info.cpu_usage);
+
+    for (const auto& proc : processes) {
+        auto it = process_cpu.find(proc.pid);
+        if (it == process_cpu.end()) {
+            ProcessEntry entry = {SlidingPercentiles(window_samples), 0};
+            it = process_cpu.emplace(proc.pid, entry).first;
+        }
+        it->second.cpu.add(proc.cpu_usage);
+        it->second.last_seen = sample_count;
+    }
+
+    // Drop exited processes so memory tracks the live process count
+    for (auto it = process_cpu.begin(); it != process_cpu.end();) {
+        if (it->second.last_seen != sample_count) {
+            it = process_cpu.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return true;
+}
+
+void UsageStatsTracker::annotate(vector<ProcessInfo>& processes, int window) const {
+    for (auto& proc : processes) {
+        auto it = process_cpu.find(proc.pid);
+        if (it == process_cpu.end()) continue;
+
+        PercentileSummary s = it->second.cpu.summary(window);
+        proc.cpu_p50 = s.p50;
+        proc.cpu_p95 = s.p95;
+        proc.cpu_p99 = s.p99;
+        proc.cpu_max = s.max;
+    }
+}
+
+PercentileSummary UsageStatsTracker::systemSummary(int window) const {
+    return system_cpu.summary(window);
+}
+
+string UsageStatsTracker::windowLabel(int window) const {
+    if (window < 0 || window >= SlidingPercentiles::kNumWindows) return "";
+    int sec = window_seconds[window];
+    if (sec % 3600 == 0) return to_string(sec / 3600) + "h";
+    if (sec % 60 == 0) return to_string(sec / 60) + "m";
+    return to_string(sec) + "s";
+}